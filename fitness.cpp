@@ -11,6 +11,147 @@ static bool startsWith(const string& s, const string& prefix) {
     return s.rfind(prefix, 0) == 0;
 }
 
+// ------------------------------
+// SCORING RULES
+// ------------------------------
+
+// ROOM SIZE + EQUIPMENT
+double roomFitScore(const Activity& act, const Room& room, FitnessResult* tally) {
+    double f = 0.0;
+
+    double cap = room.capacity;
+    double need = act.expectedEnrollment;
+    if (cap < need) {
+        f -= 0.5;
+        if (tally) tally->roomSizeViolations++;
+    }
+    else if (cap > 3 * need) {
+        f -= 0.4;
+        if (tally) tally->roomSizeViolations++;
+    }
+    else if (cap > 1.5 * need) {
+        f -= 0.2;
+        if (tally) tally->roomSizeViolations++;
+    }
+    else {
+        f += 0.3;
+    }
+
+    if (act.needsLab || act.needsProjector) {
+        int met = 0;
+        if (act.needsLab && room.hasLab) met++;
+        if (act.needsProjector && room.hasProjector) met++;
+
+        if (met == 2) f += 0.2;
+        else if (met == 1) {
+            f -= 0.1;
+            if (tally) tally->specialViolations++;
+        }
+        else {
+            f -= 0.3;
+            if (tally) tally->specialViolations++;
+        }
+    }
+    return f;
+}
+
+// FACILITATOR MATCH QUALITY
+double facilitatorMatchScore(const Activity& act, const string& fac, FitnessResult* tally) {
+    bool pref = std::find(act.preferred.begin(), act.preferred.end(), fac) != act.preferred.end();
+    bool other = std::find(act.others.begin(), act.others.end(), fac) != act.others.end();
+
+    if (pref) return 0.5;
+    if (other) return 0.2;
+    if (tally) tally->specialViolations++;
+    return -0.1;
+}
+
+// FACILITATOR LOAD AT TIMESLOT
+double facilitatorTimeScore(int count) {
+    if (count == 1) return 0.2;
+    if (count > 1) return -0.2;
+    return 0.0;
+}
+
+// ROOM CONFLICTS
+double roomClashPenalty(int count, FitnessResult* tally) {
+    if (count <= 1) return 0.0;
+    if (tally) tally->roomConflicts += count - 1;
+    return -0.5 * count;
+}
+
+// FACILITATOR LOAD
+bool isOverloaded(int count) {
+    return count > 4;
+}
+
+bool isUnderloaded(const string& fac, int count) {
+    return count > 0 && count < 3 && !(fac == "Tyler" && count < 2);
+}
+
+double facilitatorLoadPenalty(const string& fac, int count, FitnessResult* tally) {
+    if (isOverloaded(count)) {
+        if (tally) tally->facilitatorConflicts += count - 4;
+        return -0.5 * count;
+    }
+    if (isUnderloaded(fac, count)) {
+        if (tally) tally->facilitatorConflicts++;
+        return -0.4 * count;
+    }
+    return 0.0;
+}
+
+// SPECIAL SLA101 / SLA191 RULES
+const char* const SPECIAL_ACTIVITIES[4] = { "SLA101A", "SLA101B", "SLA191A", "SLA191B" };
+
+bool isRomanOrBeach(const string& room) {
+    return startsWith(room, "Roman") || startsWith(room, "Beach");
+}
+
+double specialRulesScore(const SpecialSlots& slots, FitnessResult* tally) {
+    double total = 0.0;
+
+    // Two sections of the same course: apart is good, together is bad
+    for (int first : { 0, 2 }) {
+        int t1 = slots.time[first];
+        int t2 = slots.time[first + 1];
+        if (t1 == -1 || t2 == -1) continue;
+
+        int diff = abs(t1 - t2);
+        if (diff == 0) { total -= 0.5; if (tally) tally->specialViolations++; }
+        else if (diff >= 4) total += 0.5;
+    }
+
+    // SLA191 vs SLA101: consecutive is best, if the rooms are close
+    for (int a191 : { 2, 3 }) {
+        int t1 = slots.time[a191];
+        if (t1 == -1) continue;
+
+        for (int a101 : { 0, 1 }) {
+            int t2 = slots.time[a101];
+            if (t2 == -1) continue;
+
+            int diff = abs(t1 - t2);
+
+            if (diff == 0) {
+                total -= 0.25;
+                if (tally) tally->specialViolations++;
+            }
+            else if (diff == 1) {
+                total += 0.5;
+                if (slots.romanBeach[a191] != slots.romanBeach[a101]) {
+                    total -= 0.4;
+                    if (tally) tally->specialViolations++;
+                }
+            }
+            else if (diff == 2) {
+                total += 0.25;
+            }
+        }
+    }
+    return total;
+}
+
 FitnessResult evaluateSchedule(
     const Schedule& sched,
     const vector<Activity>& activities,
@@ -61,60 +202,9 @@ FitnessResult evaluateSchedule(
         const Activity& act = actMap.at(asg.activityName);
         const Room& room = roomMap.at(asg.roomName);
 
-        double f = 0.0;
-
-        // ROOM SIZE
-        double cap = room.capacity;
-        double need = act.expectedEnrollment;
-        if (cap < need) {
-            f -= 0.5;
-            fr.roomSizeViolations++;
-        }
-        else if (cap > 3 * need) {
-            f -= 0.4;
-            fr.roomSizeViolations++;
-        }
-        else if (cap > 1.5 * need) {
-            f -= 0.2;
-            fr.roomSizeViolations++;
-        }
-        else {
-            f += 0.3;
-        }
-
-        // FACILITATOR MATCH QUALITY
-        bool pref = std::find(act.preferred.begin(), act.preferred.end(), asg.facilitator) != act.preferred.end();
-        bool other = std::find(act.others.begin(), act.others.end(), asg.facilitator) != act.others.end();
-
-        if (pref) f += 0.5;
-        else if (other) f += 0.2;
-        else {
-            f -= 0.1;
-            fr.specialViolations++;
-        }
-
-        // EQUIPMENT
-        if (act.needsLab || act.needsProjector) {
-            int met = 0;
-            if (act.needsLab && room.hasLab) met++;
-            if (act.needsProjector && room.hasProjector) met++;
-
-            if (met == 2) f += 0.2;
-            else if (met == 1) {
-                f -= 0.1;
-                fr.specialViolations++;
-            }
-            else {
-                f -= 0.3;
-                fr.specialViolations++;
-            }
-        }
-
-        // FACILITATOR LOAD AT TIMESLOT
-        string ft = asg.facilitator + "|" + asg.timeSlot;
-        int countAtTime = facTimeCount[ft];
-        if (countAtTime == 1) f += 0.2;
-        else if (countAtTime > 1) f -= 0.2;
+        double f = roomFitScore(act, room, &fr);
+        f += facilitatorMatchScore(act, asg.facilitator, &fr);
+        f += facilitatorTimeScore(facTimeCount[asg.facilitator + "|" + asg.timeSlot]);
 
         total += f;
     }
@@ -122,92 +212,19 @@ FitnessResult evaluateSchedule(
     // ------------------------------
     // SCHEDULE-LEVEL PENALTIES
     // ------------------------------
+    for (auto& p : roomTimeCount)
+        total += roomClashPenalty(p.second, &fr);
 
-    // ROOM CONFLICTS
-    for (auto& p : roomTimeCount) {
-        if (p.second > 1) {
-            int extra = p.second - 1;
-            fr.roomConflicts += extra;
-            total -= 0.5 * p.second;
-        }
-    }
-
-    // FACILITATOR LOAD
-    for (auto& p : facTotalCount) {
-        string fac = p.first;
-        int cnt = p.second;
-
-        if (cnt > 4) {
-            total -= 0.5 * cnt;
-            fr.facilitatorConflicts += (cnt - 4);
-        }
-        else if (cnt < 3) {
-            if (!(fac == "Tyler" && cnt < 2)) {
-                total -= 0.4 * cnt;
-                fr.facilitatorConflicts++;
-            }
-        }
-    }
+    for (auto& p : facTotalCount)
+        total += facilitatorLoadPenalty(p.first, p.second, &fr);
 
-    // ------------------------------
-    // SPECIAL SLA101 / SLA191 RULES
-    // ------------------------------
-    auto tIdx = [&](string name) {
-        if (!actTime.count(name)) return -1;
-        return timeIndex[actTime[name]];
-        };
-
-    auto isRB = [&](string room) {
-        return startsWith(room, "Roman") || startsWith(room, "Beach");
-        };
-
-    int t101A = tIdx("SLA101A");
-    int t101B = tIdx("SLA101B");
-    if (t101A != -1 && t101B != -1) {
-        int diff = abs(t101A - t101B);
-        if (diff == 0) { total -= 0.5; fr.specialViolations++; }
-        else if (diff >= 4) total += 0.5;
-    }
-
-    int t191A = tIdx("SLA191A");
-    int t191B = tIdx("SLA191B");
-    if (t191A != -1 && t191B != -1) {
-        int diff = abs(t191A - t191B);
-        if (diff == 0) { total -= 0.5; fr.specialViolations++; }
-        else if (diff >= 4) total += 0.5;
-    }
-
-    vector<string> a101 = { "SLA101A","SLA101B" };
-    vector<string> a191 = { "SLA191A","SLA191B" };
-
-    for (auto& n191 : a191) {
-        int t1 = tIdx(n191);
-        if (t1 == -1) continue;
-        string r1 = actRoom[n191];
-
-        for (auto& n101 : a101) {
-            int t2 = tIdx(n101);
-            if (t2 == -1) continue;
-            string r2 = actRoom[n101];
-
-            int diff = abs(t1 - t2);
-
-            if (diff == 0) {
-                total -= 0.25;
-                fr.specialViolations++;
-            }
-            else if (diff == 1) {
-                total += 0.5;
-                if (isRB(r1) != isRB(r2)) {
-                    total -= 0.4;
-                    fr.specialViolations++;
-                }
-            }
-            else if (diff == 2) {
-                total += 0.25;
-            }
-        }
+    SpecialSlots slots;
+    for (int k = 0; k < 4; k++) {
+        string name = SPECIAL_ACTIVITIES[k];
+        slots.time[k] = actTime.count(name) ? timeIndex[actTime[name]] : -1;
+        slots.romanBeach[k] = actRoom.count(name) && isRomanOrBeach(actRoom[name]);
     }
+    total += specialRulesScore(slots, &fr);
 
     fr.fitness = total;
     return fr;
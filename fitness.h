@@ -19,6 +19,42 @@ FitnessResult evaluateSchedule(
     const std::vector<std::string>& timeSlots
 );
 
+// ------------------------------
+// Scoring rules used by evaluateSchedule. Exposed so the repair operator
+// can score a single move with exactly the same rules. Each takes an
+// optional tally that collects the violations the rule counts.
+// ------------------------------
+
+// Room size + equipment score for one activity in one room
+double roomFitScore(const Activity& act, const Room& room, FitnessResult* tally = nullptr);
+
+// Preferred / other / unqualified facilitator score for one activity
+double facilitatorMatchScore(const Activity& act, const std::string& fac, FitnessResult* tally = nullptr);
+
+// Per-activity score when its facilitator has `count` activities at that time
+double facilitatorTimeScore(int count);
+
+// Penalty for a room/time slot holding `count` activities
+double roomClashPenalty(int count, FitnessResult* tally = nullptr);
+
+// Facilitator load rules for a facilitator carrying `count` activities
+bool isOverloaded(int count);
+bool isUnderloaded(const std::string& fac, int count);
+double facilitatorLoadPenalty(const std::string& fac, int count, FitnessResult* tally = nullptr);
+
+// SLA101 / SLA191 rules. SPECIAL_ACTIVITIES names the four sections;
+// SpecialSlots gives each one's time index (-1 if unscheduled) and
+// whether its room is in Roman or Beach, in the same order.
+extern const char* const SPECIAL_ACTIVITIES[4];
+
+struct SpecialSlots {
+    int time[4];
+    bool romanBeach[4];
+};
+
+bool isRomanOrBeach(const std::string& room);
+double specialRulesScore(const SpecialSlots& slots, FitnessResult* tally = nullptr);
+
 // EXTRA CREDIT REPORTING HELPERS
 std::map<std::string, int> computeRoomUtilization(const Schedule& sched);
 std::map<std::string, int> computeFacilitatorLoad(const Schedule& sched);
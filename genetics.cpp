@@ -1,10 +1,10 @@
 #include "genetic.h"
-#include <random>
+#include "rng.h"
+#include "repair.h"
 #include <algorithm>
 #include <fstream>
 #include <cmath>
-
-static std::mt19937 rng(std::random_device{}());
+#include <unordered_map>
 
 // ---------------------------------------------------
 // randomSchedule
@@ -13,19 +13,18 @@ Schedule randomSchedule(
     const std::vector<Activity>& acts,
     const std::vector<Room>& rooms,
     const std::vector<std::string>& times,
-    const std::vector<Facilitator>& facs
+    const std::vector<Facilitator>& facs,
+    RngStream& rng
 ) {
     Schedule s;
-    std::uniform_int_distribution<int> rDist(0, rooms.size() - 1);
-    std::uniform_int_distribution<int> tDist(0, times.size() - 1);
-    std::uniform_int_distribution<int> fDist(0, facs.size() - 1);
+    s.reserve(acts.size());
 
     for (auto& a : acts) {
         s.push_back({
             a.name,
-            rooms[rDist(rng)].name,
-            times[tDist(rng)],
-            facs[fDist(rng)].name
+            rooms[rng.below(rooms.size())].name,
+            times[rng.below(times.size())],
+            facs[rng.below(facs.size())].name
             });
     }
     return s;
@@ -50,9 +49,8 @@ std::vector<double> softmax(const std::vector<double>& fitnesses) {
 // ---------------------------------------------------
 // selectParent (roulette selection)
 // ---------------------------------------------------
-int selectParent(const std::vector<double>& probs) {
-    std::uniform_real_distribution<double> dist(0.0, 1.0);
-    double r = dist(rng);
+int selectParent(const std::vector<double>& probs, RngStream& rng) {
+    double r = rng.uniform();
     double acc = 0;
 
     for (int i = 0; i < probs.size(); i++) {
@@ -65,10 +63,9 @@ int selectParent(const std::vector<double>& probs) {
 // ---------------------------------------------------
 // crossover
 // ---------------------------------------------------
-Schedule crossover(const Schedule& p1, const Schedule& p2) {
+Schedule crossover(const Schedule& p1, const Schedule& p2, RngStream& rng) {
     Schedule child = p1;
-    std::uniform_int_distribution<int> cutDist(0, p1.size() - 1);
-    int cut = cutDist(rng);
+    int cut = rng.below(p1.size());
 
     for (int i = cut; i < p1.size(); i++) {
         child[i] = p2[i];
@@ -84,24 +81,88 @@ void mutate(
     const std::vector<Room>& rooms,
     const std::vector<std::string>& times,
     const std::vector<Facilitator>& facs,
-    double rate
+    double rate,
+    RngStream& rng
 ) {
-    std::uniform_real_distribution<double> prob(0.0, 1.0);
-    std::uniform_int_distribution<int> pickField(0, 2);
-    std::uniform_int_distribution<int> rDist(0, rooms.size() - 1);
-    std::uniform_int_distribution<int> tDist(0, times.size() - 1);
-    std::uniform_int_distribution<int> fDist(0, facs.size() - 1);
-
-    for (auto& a : s) {
-        if (prob(rng) < rate) {
-            int field = pickField(rng);
-            if (field == 0) a.roomName = rooms[rDist(rng)].name;
-            else if (field == 1) a.timeSlot = times[tDist(rng)];
-            else a.facilitator = facs[fDist(rng)].name;
+    // Draw the per-gene mutation rolls in one batch
+    std::vector<double> roll(s.size());
+    rng.fillUniform(roll.data(), roll.size());
+
+    for (int i = 0; i < s.size(); i++) {
+        if (roll[i] < rate) {
+            Assignment& a = s[i];
+            int field = rng.below(3);
+            if (field == 0) a.roomName = rooms[rng.below(rooms.size())].name;
+            else if (field == 1) a.timeSlot = times[rng.below(times.size())];
+            else a.facilitator = facs[rng.below(facs.size())].name;
         }
     }
 }
 
+struct DiversityStats {
+    double hamming = 0.0;   // sampled gene-wise Hamming distance, 0..1
+    double entropy = 0.0;   // mean per-gene allele entropy, 0..1
+};
+
+// ---------------------------------------------------
+// measureDiversity
+// hamming: mean fraction of differing genes over sampled pairs
+// entropy: mean normalized allele entropy per gene field
+// Both are 0 for a population of clones and approach 1 when random.
+// ---------------------------------------------------
+DiversityStats measureDiversity(
+    const Population& pop,
+    int numRooms,
+    int numTimes,
+    int numFacs,
+    RngStream& rng
+) {
+    const int SAMPLE_PAIRS = 64;
+    DiversityStats ds;
+
+    int genes = pop[0].size();
+    int fields = 3 * genes;
+
+    // Sampled gene-wise Hamming distance
+    int diff = 0;
+    for (int k = 0; k < SAMPLE_PAIRS; k++) {
+        const Schedule& a = pop[rng.below(pop.size())];
+        const Schedule& b = pop[rng.below(pop.size())];
+        for (int g = 0; g < genes; g++) {
+            if (a[g].roomName != b[g].roomName) diff++;
+            if (a[g].timeSlot != b[g].timeSlot) diff++;
+            if (a[g].facilitator != b[g].facilitator) diff++;
+        }
+    }
+    ds.hamming = (double)diff / (SAMPLE_PAIRS * fields);
+
+    // Per-gene allele entropy, normalized by the largest possible entropy
+    auto entropy = [&](const std::unordered_map<std::string, int>& counts, int domain) {
+        int maxAlleles = std::min<int>(domain, pop.size());
+        if (maxAlleles < 2) return 0.0;
+        double h = 0;
+        for (auto& p : counts) {
+            double q = (double)p.second / pop.size();
+            h -= q * std::log(q);
+        }
+        return h / std::log((double)maxAlleles);
+        };
+
+    double total = 0;
+    for (int g = 0; g < genes; g++) {
+        std::unordered_map<std::string, int> rc, tc, fc;
+        for (const auto& s : pop) {
+            rc[s[g].roomName]++;
+            tc[s[g].timeSlot]++;
+            fc[s[g].facilitator]++;
+        }
+        total += entropy(rc, numRooms) + entropy(tc, numTimes) + entropy(fc, numFacs);
+    }
+    ds.entropy = total / fields;
+
+    return ds;
+}
+
 // ---------------------------------------------------
 // runGA — MAIN GENETIC ALGORITHM
 // ---------------------------------------------------
@@ -109,17 +170,46 @@ GAResult runGA(
     const std::vector<Activity>& acts,
     const std::vector<Room>& rooms,
     const std::vector<std::string>& times,
-    const std::vector<Facilitator>& facs
+    const std::vector<Facilitator>& facs,
+    uint64_t seed
 ) {
     const int POP = 250;
-    double mutationRate = 0.01;
+    const double BASE_MUTATION = 0.01;
+    const double MAX_MUTATION = 0.2;
+
+    // Diversity response: below the threshold the mutation rate ramps up.
+    // Low generations add to a leaky counter that a recovered generation
+    // only decrements, since the mutation ramp alone briefly lifts
+    // diversity back over the line. The population is partially restarted
+    // with random immigrants (the best is kept) once the counter reaches
+    // RESTART_AFTER, or once the best fitness has stalled for STALL_GENS
+    // generations while the counter is at least STALL_LOW_GENS. The stall
+    // trigger waits STALL_COOLDOWN generations after any restart so a
+    // plateaued run is not knocked back over and over.
+    const double DIVERSITY_THRESHOLD = 0.15;
+    const int RESTART_AFTER = 10;
+    const int STALL_GENS = 15;
+    const int STALL_LOW_GENS = 3;
+    const int STALL_COOLDOWN = 40;
+    const double IMMIGRANT_FRACTION = 0.3;
+
+    double mutationRate = BASE_MUTATION;
+    int lowDiversityGens = 0;
+    int stalledGens = 0;
+    int sinceRestart = STALL_COOLDOWN;
+
+    // Fraction of children passed through the conflict-directed repair
+    const double REPAIR_RATE = 0.5;
+    RepairContext repairCtx = buildRepairContext(acts, rooms, times, facs);
 
     Population pop;
     pop.reserve(POP);
 
     // Initialize random population
-    for (int i = 0; i < POP; i++)
-        pop.push_back(randomSchedule(acts, rooms, times, facs));
+    for (int i = 0; i < POP; i++) {
+        RngStream initRng(seed, 0, i, OP_INIT);
+        pop.push_back(randomSchedule(acts, rooms, times, facs, initRng));
+    }
 
     // Fitness log
     std::ofstream log("fitness_over_time.csv");
@@ -129,9 +219,14 @@ GAResult runGA(
     std::ofstream mutateLog("mutation_history.csv");
     mutateLog << "Generation,MutationRate\n";
 
+    // Diversity log
+    std::ofstream divLog("diversity_over_time.csv");
+    divLog << "Generation,Hamming,Entropy,Restart\n";
+
     double prevAvg = 0;
     GAResult result{};
     result.bestFitness = -1e18;
+    result.seed = seed;
 
     int gen = 0;
 
@@ -168,10 +263,46 @@ GAResult runGA(
         if (best > result.bestFitness) {
             result.bestFitness = best;
             result.bestSchedule = pop[bestIdx];
+            stalledGens = 0;
+        }
+        else {
+            stalledGens++;
+        }
+
+        bool stop = gen >= 100 && std::abs(improvement) < 1.0;
+
+        // ----- DIVERSITY -----
+        // Measured and logged every generation, including the last, so
+        // the rows line up with fitness_over_time.csv
+        RngStream divRng(seed, gen, 0, OP_DIVERSITY);
+        DiversityStats ds = measureDiversity(pop, rooms.size(), times.size(), facs.size(), divRng);
+
+        bool restart = false;
+        if (!stop) {
+            if (ds.hamming < DIVERSITY_THRESHOLD) {
+                mutationRate = std::min(MAX_MUTATION, mutationRate * 1.5);
+                lowDiversityGens++;
+            }
+            else {
+                mutationRate = std::max(BASE_MUTATION, mutationRate * 0.9);
+                lowDiversityGens = std::max(0, lowDiversityGens - 1);
+            }
+
+            sinceRestart++;
+            restart = lowDiversityGens >= RESTART_AFTER
+                || (stalledGens >= STALL_GENS && lowDiversityGens >= STALL_LOW_GENS
+                    && sinceRestart >= STALL_COOLDOWN);
+            if (restart) {
+                lowDiversityGens = 0;
+                stalledGens = 0;
+                sinceRestart = 0;
+            }
         }
 
+        divLog << gen << "," << ds.hamming << "," << ds.entropy << "," << restart << "\n";
+
         // ----- STOPPING CRITERIA -----
-        if (gen >= 100 && std::abs(improvement) < 1.0)
+        if (stop)
             break;
 
         prevAvg = avg;
@@ -180,22 +311,54 @@ GAResult runGA(
         auto probs = softmax(f);
 
         // ----- NEXT GENERATION -----
-        Population nextPop;
-        nextPop.reserve(POP);
-
-        while (nextPop.size() < POP) {
-            int p1 = selectParent(probs);
-            int p2 = selectParent(probs);
-            if (p1 == p2) continue;
-
-            Schedule c1 = crossover(pop[p1], pop[p2]);
-            Schedule c2 = crossover(pop[p2], pop[p1]);
-
-            mutate(c1, rooms, times, facs, mutationRate);
-            mutate(c2, rooms, times, facs, mutationRate);
+        // Pair k fills slots 2k and 2k+1. Every draw comes from a stream
+        // addressed by (gen, slot, operator), so pairs are independent of
+        // each other and the run is reproducible from the seed alone.
+        // On a restart only slots below `bred` are bred; the rest are
+        // filled by the partial restart below.
+        Population nextPop(POP);
+        int bred = restart ? POP - (int)(POP * IMMIGRANT_FRACTION) : POP;
+
+        for (int k = 0; 2 * k < bred; k++) {
+            int s1 = 2 * k;
+            int s2 = 2 * k + 1;
+
+            RngStream selRng(seed, gen, k, OP_SELECT);
+            int p1, p2;
+            do {
+                p1 = selectParent(probs, selRng);
+                p2 = selectParent(probs, selRng);
+            } while (p1 == p2);
+
+            RngStream crossRng(seed, gen, k, OP_CROSSOVER);
+            Schedule c1 = crossover(pop[p1], pop[p2], crossRng);
+            Schedule c2 = crossover(pop[p2], pop[p1], crossRng);
+
+            RngStream mutRng1(seed, gen, s1, OP_MUTATE);
+            mutate(c1, rooms, times, facs, mutationRate, mutRng1);
+            RngStream repRng1(seed, gen, s1, OP_REPAIR);
+            if (repRng1.uniform() < REPAIR_RATE)
+                repairSchedule(c1, acts, rooms, times, facs, repairCtx, repRng1);
+            nextPop[s1] = c1;
+
+            if (s2 < bred) {
+                RngStream mutRng2(seed, gen, s2, OP_MUTATE);
+                mutate(c2, rooms, times, facs, mutationRate, mutRng2);
+                RngStream repRng2(seed, gen, s2, OP_REPAIR);
+                if (repRng2.uniform() < REPAIR_RATE)
+                    repairSchedule(c2, acts, rooms, times, facs, repairCtx, repRng2);
+                nextPop[s2] = c2;
+            }
+        }
 
-            nextPop.push_back(c1);
-            if (nextPop.size() < POP) nextPop.push_back(c2);
+        // ----- PARTIAL RESTART -----
+        // Best schedule so far, then random immigrants
+        if (restart) {
+            nextPop[bred] = result.bestSchedule;
+            for (int i = bred + 1; i < POP; i++) {
+                RngStream immRng(seed, gen, i, OP_IMMIGRANT);
+                nextPop[i] = randomSchedule(acts, rooms, times, facs, immRng);
+            }
         }
 
         pop = nextPop;
@@ -1,16 +1,19 @@
 #pragma once
 #include <vector>
+#include <cstdint>
 #include "data.h"
 #include "fitness.h"
 
 struct GAResult {
     Schedule bestSchedule;
     double bestFitness;
+    uint64_t seed;      // rerun with this seed to reproduce the result
 };
 
 GAResult runGA(
     const std::vector<Activity>& activities,
     const std::vector<Room>& rooms,
     const std::vector<std::string>& timeSlots,
-    const std::vector<Facilitator>& facs
+    const std::vector<Facilitator>& facs,
+    uint64_t seed
 );
@@ -4,6 +4,10 @@
 #include "fitness.h"
 #include "genetic.h"
 #include <map>
+#include <random>
+#include <string>
+#include <cctype>
+#include <cstdint>
 
 // ASCII bar chart helper (extra credit)
 std::string bar(int count, int max = 20) {
@@ -11,7 +15,7 @@ std::string bar(int count, int max = 20) {
     return std::string(len, '#');
 }
 
-int main() {
+int main(int argc, char** argv) {
     std::vector<Activity> activities;
     std::vector<Room> rooms;
     std::vector<std::string> timeSlots;
@@ -20,14 +24,36 @@ int main() {
     loadData(activities, rooms, timeSlots, facs);
 
 
-    GAResult result = runGA(activities, rooms, timeSlots, facs);
+    // Pass a seed on the command line to reproduce an earlier run
+    uint64_t seed = ((uint64_t)std::random_device{}() << 32) | std::random_device{}();
+    if (argc > 1) {
+        std::string arg = argv[1];
+        size_t used = 0;
+        bool ok = !arg.empty() && isdigit((unsigned char)arg[0]);
+        if (ok) {
+            try {
+                seed = std::stoull(arg, &used);
+            }
+            catch (const std::exception&) {
+                ok = false;
+            }
+        }
+        if (!ok || used != arg.size()) {
+            std::cerr << "Usage: " << argv[0] << " [seed]\n"
+                << "  seed: non-negative integer up to " << UINT64_MAX << "\n";
+            return 1;
+        }
+    }
+
+    GAResult result = runGA(activities, rooms, timeSlots, facs, seed);
 
     // Evaluate violations for reporting
     FitnessResult stats = evaluateSchedule(result.bestSchedule, activities, rooms, timeSlots);
 
    
     std::ofstream out("best_schedule.txt");
-    out << "Best Fitness = " << result.bestFitness << "\n\n";
+    out << "Best Fitness = " << result.bestFitness << "\n";
+    out << "Seed = " << result.seed << "\n\n";
 
     out << "Constraint Summary:\n";
     out << "Room Conflicts: " << stats.roomConflicts << "\n";
@@ -93,12 +119,14 @@ int main() {
     std::cout << " Genetic Algorithm\n";
     std::cout << "------------------------------------------\n";
     std::cout << "Best fitness: " << result.bestFitness << "\n";
+    std::cout << "Seed: " << result.seed << "\n";
     std::cout << "Best schedule saved to: best_schedule.txt\n";
     std::cout << "Fitness log saved to: fitness_over_time.csv\n";
     std::cout << " Additional CSVs saved:\n";
     std::cout << "  - violations_report.csv\n";
     std::cout << "  - room_utilization.csv\n";
     std::cout << "  - facilitator_load.csv\n";
+    std::cout << "  - diversity_over_time.csv\n";
     std::cout << "ASCII charts displayed n\n";
 
     return 0;
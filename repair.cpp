@@ -0,0 +1,370 @@
+#include "repair.h"
+#include <algorithm>
+
+static const int CELL_SAMPLES = 4;     // free cells considered per room move
+
+// Append item to list / swap-remove it, keeping pos[item] = its index
+static void listAdd(std::vector<int>& list, std::vector<int>& pos, int item) {
+    pos[item] = list.size();
+    list.push_back(item);
+}
+
+static void listRemove(std::vector<int>& list, std::vector<int>& pos, int item) {
+    int last = list.back();
+    list[pos[item]] = last;
+    pos[last] = pos[item];
+    list.pop_back();
+    pos[item] = -1;
+}
+
+// ---------------------------------------------------
+// Occupancy — per-schedule assignment indexes: which activities sit in
+// each room/time cell, which each facilitator leads, facilitator/time
+// counts and the free room/time cells. Every update is O(1).
+// ---------------------------------------------------
+struct Occupancy {
+    int numTimes;
+    std::vector<int> room, time, fac;        // [activity]
+
+    std::vector<std::vector<int>> cellActs;  // [room * numTimes + time]
+    std::vector<std::vector<int>> facActs;   // [fac]
+    std::vector<int> cellPos, facPos;        // [activity] index into the above
+    std::vector<int> facTime;                // [fac * numTimes + time]
+
+    std::vector<int> freeCells;
+    std::vector<int> freePos;    // [cell] index into freeCells, or -1 if occupied
+
+    Occupancy(int acts, int rooms, int times, int facs)
+        : numTimes(times),
+        room(acts), time(acts), fac(acts),
+        cellActs(rooms * times),
+        facActs(facs),
+        cellPos(acts, -1),
+        facPos(acts, -1),
+        facTime(facs * times, 0),
+        freePos(rooms * times, -1) {
+        for (int c = 0; c < rooms * times; c++)
+            listAdd(freeCells, freePos, c);
+    }
+
+    int roomCount(int cell) const { return cellActs[cell].size(); }
+    int facLoad(int f) const { return facActs[f].size(); }
+
+    void place(int a, int r, int t, int f) {
+        room[a] = r; time[a] = t; fac[a] = f;
+        occupyRoom(a, r * numTimes + t);
+        listAdd(facActs[f], facPos, a);
+        facTime[f * numTimes + t]++;
+    }
+
+    void occupyRoom(int a, int cell) {
+        if (cellActs[cell].empty()) listRemove(freeCells, freePos, cell);
+        listAdd(cellActs[cell], cellPos, a);
+    }
+
+    void releaseRoom(int a, int cell) {
+        listRemove(cellActs[cell], cellPos, a);
+        if (cellActs[cell].empty()) listAdd(freeCells, freePos, cell);
+    }
+
+    // Move activity a to a room/time cell, keeping its facilitator
+    void moveRoom(int a, int cell) {
+        releaseRoom(a, room[a] * numTimes + time[a]);
+        facTime[fac[a] * numTimes + time[a]]--;
+
+        room[a] = cell / numTimes;
+        time[a] = cell % numTimes;
+
+        occupyRoom(a, cell);
+        facTime[fac[a] * numTimes + time[a]]++;
+    }
+
+    // Hand activity a to facilitator f
+    void moveFac(int a, int f) {
+        int t = time[a];
+        listRemove(facActs[fac[a]], facPos, a);
+        facTime[fac[a] * numTimes + t]--;
+
+        fac[a] = f;
+
+        listAdd(facActs[f], facPos, a);
+        facTime[f * numTimes + t]++;
+    }
+};
+
+// ---------------------------------------------------
+// buildRepairContext
+// ---------------------------------------------------
+RepairContext buildRepairContext(
+    const std::vector<Activity>& acts,
+    const std::vector<Room>& rooms,
+    const std::vector<std::string>& times,
+    const std::vector<Facilitator>& facs
+) {
+    RepairContext ctx;
+    for (int i = 0; i < rooms.size(); i++) ctx.roomIdx[rooms[i].name] = i;
+    for (int i = 0; i < times.size(); i++) ctx.timeIdx[times[i]] = i;
+    for (int i = 0; i < facs.size(); i++) ctx.facIdx[facs[i].name] = i;
+
+    ctx.qualified.resize(acts.size());
+    for (int a = 0; a < acts.size(); a++) {
+        auto& q = ctx.qualified[a];
+        auto add = [&](const std::string& name) {
+            auto it = ctx.facIdx.find(name);
+            if (it == ctx.facIdx.end()) return;
+            if (std::find(q.begin(), q.end(), it->second) == q.end())
+                q.push_back(it->second);
+            };
+        for (auto& n : acts[a].preferred) add(n);
+        for (auto& n : acts[a].others) add(n);
+    }
+
+    ctx.roomFit.assign(acts.size(), std::vector<double>(rooms.size()));
+    ctx.facMatch.assign(acts.size(), std::vector<double>(facs.size()));
+    ctx.canTeach.resize(facs.size());
+    for (int a = 0; a < acts.size(); a++) {
+        for (int r = 0; r < rooms.size(); r++)
+            ctx.roomFit[a][r] = roomFitScore(acts[a], rooms[r]);
+        for (int f = 0; f < facs.size(); f++)
+            ctx.facMatch[a][f] = facilitatorMatchScore(acts[a], facs[f].name);
+        for (int f : ctx.qualified[a]) ctx.canTeach[f].push_back(a);
+    }
+
+    ctx.loadPenalty.assign(facs.size(), std::vector<double>(acts.size() + 1));
+    ctx.underloaded.assign(facs.size(), std::vector<bool>(acts.size() + 1));
+    for (int f = 0; f < facs.size(); f++) {
+        for (int cnt = 0; cnt <= acts.size(); cnt++) {
+            ctx.loadPenalty[f][cnt] = facilitatorLoadPenalty(facs[f].name, cnt);
+            ctx.underloaded[f][cnt] = isUnderloaded(facs[f].name, cnt);
+        }
+    }
+
+    for (int k = 0; k < 4; k++) {
+        ctx.special[k] = -1;
+        for (int a = 0; a < acts.size(); a++)
+            if (acts[a].name == SPECIAL_ACTIVITIES[k]) ctx.special[k] = a;
+    }
+    for (auto& r : rooms)
+        ctx.romanBeach.push_back(isRomanOrBeach(r.name));
+
+    return ctx;
+}
+
+// Summed facilitatorTimeScore for a facilitator/time cell holding n activities
+static double facTimeCellScore(int n) {
+    return n * facilitatorTimeScore(n);
+}
+
+// specialRulesScore, given every activity's time and room index
+static double specialScore(const RepairContext& ctx, const std::vector<int>& time, const std::vector<int>& room) {
+    SpecialSlots slots;
+    for (int k = 0; k < 4; k++) {
+        int a = ctx.special[k];
+        slots.time[k] = (a == -1) ? -1 : time[a];
+        slots.romanBeach[k] = (a != -1) && ctx.romanBeach[room[a]];
+    }
+    return specialRulesScore(slots);
+}
+
+// ---------------------------------------------------
+// repairSchedule
+// ---------------------------------------------------
+void repairSchedule(
+    Schedule& s,
+    const std::vector<Activity>& acts,
+    const std::vector<Room>& rooms,
+    const std::vector<std::string>& times,
+    const std::vector<Facilitator>& facs,
+    const RepairContext& ctx,
+    RngStream& rng
+) {
+    // The per-activity tables are indexed by position in acts; a schedule
+    // in any other order is left as it is
+    if (s.size() != acts.size()) return;
+    for (int i = 0; i < s.size(); i++)
+        if (s[i].activityName != acts[i].name) return;
+
+    int n = s.size();
+    int T = times.size();
+
+    Occupancy occ(n, rooms.size(), T, facs.size());
+    for (int i = 0; i < n; i++) {
+        occ.place(i,
+            ctx.roomIdx.at(s[i].roomName),
+            ctx.timeIdx.at(s[i].timeSlot),
+            ctx.facIdx.at(s[i].facilitator));
+    }
+
+    std::vector<int>& room = occ.room;
+    std::vector<int>& time = occ.time;
+    std::vector<int>& fac = occ.fac;
+
+    // Random starting point so clashes are not always handled in
+    // activity order
+    int start = rng.below(n);
+
+    // Exact fitness change from moving activity j to free cell c
+    auto roomMoveDelta = [&](int j, int c) {
+        int r1 = room[j], t1 = time[j];
+        int r2 = c / T, t2 = c % T;
+
+        double d = ctx.roomFit[j][r2] - ctx.roomFit[j][r1];
+
+        int n1 = occ.roomCount(r1 * T + t1);
+        d += roomClashPenalty(n1 - 1) - roomClashPenalty(n1);
+
+        if (t2 != t1) {
+            int a = occ.facTime[fac[j] * T + t1];
+            int b = occ.facTime[fac[j] * T + t2];
+            d += facTimeCellScore(a - 1) - facTimeCellScore(a) + facTimeCellScore(b + 1) - facTimeCellScore(b);
+        }
+
+        double before = specialScore(ctx, time, room);
+        room[j] = r2; time[j] = t2;
+        d += specialScore(ctx, time, room) - before;
+        room[j] = r1; time[j] = t1;
+
+        return d;
+        };
+
+    // ----- ROOM / TIME CONFLICTS -----
+    for (int k = 0; k < n; k++) {
+        int i = (start + k) % n;
+        int cell = room[i] * T + time[i];
+        if (occ.roomCount(cell) <= 1) continue;
+
+        // Any activity in the clash may move. Candidates are every free
+        // room at the same time plus a few sampled free cells at other
+        // times; a room that suits the activity worse is never taken.
+        int bestAct = -1, bestCell = -1;
+        double bestDelta = 0;
+
+        auto consider = [&](int j, int c) {
+            if (ctx.roomFit[j][c / T] < ctx.roomFit[j][room[j]]) return;
+            double d = roomMoveDelta(j, c);
+            if (d > bestDelta) { bestDelta = d; bestAct = j; bestCell = c; }
+            };
+
+        for (int j : occ.cellActs[cell]) {
+            for (int r = 0; r < rooms.size(); r++)
+                if (occ.roomCount(r * T + time[j]) == 0) consider(j, r * T + time[j]);
+
+            for (int m = 0; m < CELL_SAMPLES && !occ.freeCells.empty(); m++)
+                consider(j, occ.freeCells[rng.below(occ.freeCells.size())]);
+        }
+
+        if (bestAct != -1) occ.moveRoom(bestAct, bestCell);
+    }
+
+    // Exact fitness change from handing activity i to facilitator c
+    auto facMoveDelta = [&](int i, int c) {
+        int f = fac[i], t = time[i];
+        int a = occ.facTime[f * T + t], b = occ.facTime[c * T + t];
+        int la = occ.facLoad(f), lb = occ.facLoad(c);
+
+        return ctx.facMatch[i][c] - ctx.facMatch[i][f]
+            + facTimeCellScore(a - 1) - facTimeCellScore(a) + facTimeCellScore(b + 1) - facTimeCellScore(b)
+            + ctx.loadPenalty[f][la - 1] - ctx.loadPenalty[f][la]
+            + ctx.loadPenalty[c][lb + 1] - ctx.loadPenalty[c][lb];
+        };
+
+    // A facilitator can take activity i if that leaves them neither
+    // overloaded nor underloaded
+    auto canTake = [&](int c) {
+        int load = occ.facLoad(c) + 1;
+        return !isOverloaded(load) && !ctx.underloaded[c][load];
+        };
+
+    // ----- FACILITATOR CONFLICTS / OVERLOAD -----
+    for (int k = 0; k < n; k++) {
+        int i = (start + k) % n;
+        int f = fac[i];
+        if (occ.facTime[f * T + time[i]] <= 1 && !isOverloaded(occ.facLoad(f))) continue;
+
+        int target = -1;
+        double bestDelta = 0;
+        for (int c : ctx.qualified[i]) {
+            if (c == f || !canTake(c)) continue;
+            double d = facMoveDelta(i, c);
+            if (d > bestDelta) { bestDelta = d; target = c; }
+        }
+        if (target != -1) occ.moveFac(i, target);
+    }
+
+    // ----- FACILITATOR UNDERLOAD -----
+    // An underloaded facilitator is either drained (each of their
+    // activities goes to a qualified facilitator who can take it) or
+    // filled until no longer underloaded from facilitators who can spare one.
+    // Both are tried as a whole and the better one is kept if it
+    // improves fitness.
+    struct FacMove { int act, from, to; };
+    const double FAILED = -1e18;
+
+    auto drain = [&](int u, std::vector<FacMove>& moves) {
+        double total = 0;
+        std::vector<int> mine = occ.facActs[u];   // copy: moves edit the list
+        for (int i : mine) {
+            int target = -1;
+            double bestDelta = FAILED;
+            for (int c : ctx.qualified[i]) {
+                if (c == u || !canTake(c)) continue;
+                double d = facMoveDelta(i, c);
+                if (d > bestDelta) { bestDelta = d; target = c; }
+            }
+            if (target == -1) return FAILED;
+
+            total += bestDelta;
+            moves.push_back({ i, u, target });
+            occ.moveFac(i, target);
+        }
+        return total;
+        };
+
+    auto fill = [&](int u, std::vector<FacMove>& moves) {
+        double total = 0;
+        while (ctx.underloaded[u][occ.facLoad(u)]) {
+            int bestAct = -1;
+            double bestDelta = FAILED;
+            for (int i : ctx.canTeach[u]) {
+                int donor = fac[i];
+                if (donor == u || ctx.underloaded[donor][occ.facLoad(donor) - 1]) continue;
+                double d = facMoveDelta(i, u);
+                if (d > bestDelta) { bestDelta = d; bestAct = i; }
+            }
+            if (bestAct == -1) return FAILED;
+
+            total += bestDelta;
+            moves.push_back({ bestAct, fac[bestAct], u });
+            occ.moveFac(bestAct, u);
+        }
+        return total;
+        };
+
+    auto undo = [&](const std::vector<FacMove>& moves) {
+        for (int m = (int)moves.size() - 1; m >= 0; m--)
+            occ.moveFac(moves[m].act, moves[m].from);
+        };
+
+    int numFacs = facs.size();
+    int facStart = rng.below(numFacs);
+    for (int k = 0; k < numFacs; k++) {
+        int u = (facStart + k) % numFacs;
+        if (!ctx.underloaded[u][occ.facLoad(u)]) continue;
+
+        std::vector<FacMove> drained, filled;
+        double drainDelta = drain(u, drained);
+        undo(drained);
+        double fillDelta = fill(u, filled);
+        undo(filled);
+
+        const auto& best = (drainDelta >= fillDelta) ? drained : filled;
+        if (std::max(drainDelta, fillDelta) <= 0) continue;
+        for (const auto& m : best) occ.moveFac(m.act, m.to);
+    }
+
+    for (int i = 0; i < n; i++) {
+        s[i].roomName = rooms[room[i]].name;
+        s[i].timeSlot = times[time[i]];
+        s[i].facilitator = facs[fac[i]].name;
+    }
+}
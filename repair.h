@@ -0,0 +1,64 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "data.h"
+#include "fitness.h"
+#include "rng.h"
+
+// Name -> index lookups and per-index scores shared by every repair in a
+// run. Built once in runGA from the scoring rules in fitness.h; the repair
+// itself works on integer indexes only.
+struct RepairContext {
+    std::unordered_map<std::string, int> roomIdx;
+    std::unordered_map<std::string, int> timeIdx;
+    std::unordered_map<std::string, int> facIdx;
+
+    // per activity: qualified facilitators, preferred first, then others
+    std::vector<std::vector<int>> qualified;
+
+    // per activity, per room: roomFitScore
+    std::vector<std::vector<double>> roomFit;
+
+    // per activity, per facilitator: facilitatorMatchScore
+    std::vector<std::vector<double>> facMatch;
+
+    // per facilitator: activities they are qualified for
+    std::vector<std::vector<int>> canTeach;
+
+    // per facilitator, per load 0..activities: facilitatorLoadPenalty
+    // and isUnderloaded
+    std::vector<std::vector<double>> loadPenalty;
+    std::vector<std::vector<bool>> underloaded;
+
+    // activity index of each SPECIAL_ACTIVITIES entry (-1 if absent) and
+    // isRomanOrBeach per room
+    int special[4];
+    std::vector<bool> romanBeach;
+};
+
+RepairContext buildRepairContext(
+    const std::vector<Activity>& acts,
+    const std::vector<Room>& rooms,
+    const std::vector<std::string>& times,
+    const std::vector<Facilitator>& facs
+);
+
+// Conflict-directed repair. Builds room x time and facilitator x time
+// occupancy for the schedule, then moves activities out of double-booked
+// rooms into free cells, hands double-booked or overloaded activities to
+// other qualified facilitators, and clears underloaded facilitators by
+// moving their activities away or giving them more. Each candidate move is
+// scored with the exact fitness change it causes, and only moves that
+// improve fitness are made, so a repair never lowers it.
+// s[i] must be the assignment for acts[i], as randomSchedule builds it;
+// a schedule in any other order is returned unchanged.
+void repairSchedule(
+    Schedule& s,
+    const std::vector<Activity>& acts,
+    const std::vector<Room>& rooms,
+    const std::vector<std::string>& times,
+    const std::vector<Facilitator>& facs,
+    const RepairContext& ctx,
+    RngStream& rng
+);
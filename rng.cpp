@@ -0,0 +1,88 @@
+#include "rng.h"
+
+// Philox4x32 constants (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+static const uint32_t PHILOX_M0 = 0xD2511F53u;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57u;
+static const uint32_t PHILOX_W0 = 0x9E3779B9u;
+static const uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+// ---------------------------------------------------
+// philox4x32 — 10 rounds, one 128-bit block per call
+// ---------------------------------------------------
+static void philox4x32(const uint32_t in[4], const uint32_t keyIn[2], uint32_t out[4]) {
+    uint32_t c0 = in[0], c1 = in[1], c2 = in[2], c3 = in[3];
+    uint32_t k0 = keyIn[0], k1 = keyIn[1];
+
+    for (int round = 0; round < 10; round++) {
+        uint64_t p0 = (uint64_t)PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t)PHILOX_M1 * c2;
+
+        uint32_t n0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+        uint32_t n1 = (uint32_t)p1;
+        uint32_t n2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+        uint32_t n3 = (uint32_t)p0;
+
+        c0 = n0; c1 = n1; c2 = n2; c3 = n3;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+
+    out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+}
+
+// ---------------------------------------------------
+// RngStream
+// ---------------------------------------------------
+RngStream::RngStream(uint64_t seed, uint32_t gen, uint32_t individual, RngOp op) {
+    key[0] = (uint32_t)seed;
+    key[1] = (uint32_t)(seed >> 32);
+
+    // ctr[0] is the block index within the stream; the rest is its address
+    ctr[0] = 0;
+    ctr[1] = individual;
+    ctr[2] = gen;
+    ctr[3] = op;
+
+    pos = 4; // buffer empty
+}
+
+void RngStream::refill() {
+    philox4x32(ctr, key, buf);
+    ctr[0]++;
+    pos = 0;
+}
+
+uint32_t RngStream::next() {
+    if (pos == 4) refill();
+    return buf[pos++];
+}
+
+double RngStream::uniform() {
+    return next() * (1.0 / 4294967296.0);
+}
+
+int RngStream::below(int n) {
+    // multiply-shift: maps 32 bits onto [0, n) without a division
+    return (int)(((uint64_t)next() * (uint32_t)n) >> 32);
+}
+
+void RngStream::fillUniform(double* out, size_t n) {
+    size_t i = 0;
+
+    // drain whatever is left in the current block
+    while (i < n && pos < 4)
+        out[i++] = buf[pos++] * (1.0 / 4294967296.0);
+
+    // whole blocks straight into the output
+    uint32_t block[4];
+    while (n - i >= 4) {
+        philox4x32(ctr, key, block);
+        ctr[0]++;
+        for (int j = 0; j < 4; j++)
+            out[i + j] = block[j] * (1.0 / 4294967296.0);
+        i += 4;
+    }
+
+    while (i < n)
+        out[i++] = uniform();
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+// Which GA operator a stream belongs to. Part of the stream address,
+// so every operator draws from its own independent sequence.
+enum RngOp : uint32_t {
+    OP_INIT = 0,
+    OP_SELECT = 1,
+    OP_CROSSOVER = 2,
+    OP_MUTATE = 3,
+    OP_DIVERSITY = 4,
+    OP_IMMIGRANT = 5,
+    OP_REPAIR = 6
+};
+
+// Counter-based random stream (Philox4x32-10).
+// A stream is addressed by (seed, generation, individual, operator), so the
+// numbers an operator sees depend only on that address — never on how many
+// draws other individuals made or which thread ran first.
+class RngStream {
+public:
+    RngStream(uint64_t seed, uint32_t gen, uint32_t individual, RngOp op);
+
+    uint32_t next();                      // raw 32-bit value
+    double uniform();                     // [0, 1)
+    int below(int n);                     // [0, n)
+    void fillUniform(double* out, size_t n); // n values of uniform(), in bulk
+
+private:
+    void refill();
+
+    uint32_t key[2];
+    uint32_t ctr[4];
+    uint32_t buf[4];
+    int pos;
+};